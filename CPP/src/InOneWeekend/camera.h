@@ -3,12 +3,20 @@
 
 #include "rtweekend.h"
 
+#include "camera_variant.h"
 #include "color.h"
 #include "hittable.h"
+#include "hittable_list.h"
 #include "material.h"
+#include "tile_queue.h"
 
+#include <algorithm>
+#include <atomic>
+#include <chrono>
 #include <iosfwd>
+#include <sstream>
 #include <thread>
+#include <vector>
 
 class camera {
   public:
@@ -66,67 +74,357 @@ class camera {
     }
 
     void render(const hittable& world, std::ostream &out) const noexcept {
-      out << "P3\n" << image_width << ' ' << image_height << "\n255\n";
-      const int thread_count = std::thread::hardware_concurrency();
+      render(world, hittable_list(), out);
+    }
 
-      if (thread_count) {
-        std::vector<std::thread> threads;
-        threads.reserve(thread_count);
+    // Every emissive object in `world` should also be in `lights`, since diffuse surfaces get their
+    // direct lighting by sampling `lights` and skip emission found by their scattered rays.
+    // The sampler and output encoding are chosen at compile time. The lens and bounce limit use the
+    // runtime checks, unless built with RTW_SPECIALIZED_VARIANTS (see `dispatch`).
+    template <typename Sampler = jittered_sampler, typename Output = ppm_ascii>
+    void render(const hittable& world, const hittable& lights, std::ostream &out) const noexcept {
+      dispatch<Sampler, Output>([this, &world, &lights, &out]<typename Variant>() {
+        render_variant<Variant>(world, lights, out);
+      });
+    }
 
-        std::vector<std::vector<color>> thread_results;
-        thread_results.reserve(thread_count);
-        // I manually reserve the size to allow the threads to directly assign their results later without worrying about resizing and clearing
-        for (int t = 0; t < thread_count; ++t)
-          thread_results[t].reserve(image_width);
+    // Deadline-aware mode: ignores `samples_per_pixel` and keeps adding samples until `budget` runs out.
+    // An initial pass gives every tile `initial_samples` while measuring throughput, then each following
+    // pass only samples the noisiest tiles, as many as are expected to fit in the time left. The initial
+    // pass also stops at the deadline; tiles it didn't reach are filled in from the closest sampled
+    // scanline and reported. A small part of the budget is kept for writing the image.
+    // Returns the number of samples each pixel received, row by row (0 for filled in pixels).
+    template <typename Sampler = jittered_sampler, typename Output = ppm_ascii>
+    std::vector<int> render(const hittable& world, const hittable& lights, std::ostream &out,
+                            const std::chrono::milliseconds budget) const noexcept {
+      std::vector<int> achieved;
+      dispatch<Sampler, Output>([this, &world, &lights, &out, budget, &achieved]<typename Variant>() {
+        achieved = render_variant<Variant>(world, lights, out, budget);
+      });
+      return achieved;
+    }
 
-        // Render a whole line per thread to get better utilization out of each thread.
-        auto render_line = [this, &world, &thread_results](int j, int thread_id) {
-          for (int i = 0; i < image_width; ++i) {
-            thread_results[thread_id][i] = render_kernel(world, j, i);
-          }
-        };
-
-        // Only create as many threads as the CPU can handle, to avoid overloading the system
-        for (int j = 0; j < image_height;) {
-          std::clog << "\rScanlines remaining: " << (image_height - j) << ' ' << std::flush;
-          // Create as many threads as possible, up to the last row
-          for (int t = 0; t < thread_count && j + t < image_height; ++t) {
-            // std::cout << "starting thread for line `" << j+t << "`." << std::endl;
-            threads[t] = std::thread(render_line, j+t, t);
-          }
+    // Renders with a specific `camera_variant`, whether or not it matches this camera's settings.
+    // A fixed lens or depth policy overrides `defocus_angle` or `max_depth`.
+    template <typename Variant>
+    void render_variant(const hittable& world, const hittable& lights, std::ostream &out) const noexcept {
+      const auto start = std::chrono::steady_clock::now();
 
-          for (int t = 0; t < thread_count && j + t < image_height; ++t) {
-            threads[t].join();
-            for (int i = 0; i < image_width; ++i) {
-              write_color(out, thread_results[t][i]);
-            }
+      // Render threads fill in the frame buffer a tile (band of scanlines) at a time, then hand the
+      // finished tile to the writer thread so they never wait on I/O.
+      const int tile_count = (image_height + tile_height - 1) / tile_height;
+      std::vector<color> frame(image_width * image_height);
+      tile_queue finished(tile_count);
+
+      std::chrono::steady_clock::time_point first_tile_written;
+      std::thread writer([this, &out, &frame, &finished, &first_tile_written] {
+        write_tiles<typename Variant::output>(out, frame, finished, first_tile_written, true);
+      });
+
+      for_each_tile(tile_count, [this, &world, &lights, &frame, &finished](const int tile) {
+        const int last_row = std::min((tile + 1) * tile_height, image_height);
+        for (int j = tile * tile_height; j < last_row; ++j) {
+          for (int i = 0; i < image_width; ++i) {
+            frame[j * image_width + i] = render_kernel<Variant>(world, lights, j, i);
           }
-          j += thread_count;
         }
-      } else {
-        // If the cpu count wasn't found for some reason, perform the original single threaded algorithm
-        for (int j = 0; j < image_height; ++j) {
-          std::clog << "\rScanlines remaining: " << (image_height - j) << ' ' << std::flush;
+        finished.push(tile);
+      });
+      writer.join();
+
+      using ms = std::chrono::duration<double, std::milli>;
+      const auto end = std::chrono::steady_clock::now();
+      // the spaces to cover the scanlines remaining message
+      std::clog << "\rDone.                 \n"
+                << "Time to first tile: " << ms(first_tile_written - start).count() << " ms\n"
+                << "Total time: " << ms(end - start).count() << " ms\n";
+    }
+
+    template <typename Variant>
+    std::vector<int> render_variant(const hittable& world, const hittable& lights, std::ostream &out,
+                                    const std::chrono::milliseconds budget) const noexcept {
+      using clock = std::chrono::steady_clock;
+      const auto start = clock::now();
+      const auto deadline = start + budget - budget / output_reserve;
+
+      const int tile_count = (image_height + tile_height - 1) / tile_height;
+      std::vector<pixel_estimate> estimates(image_width * image_height);
+
+      // Adds `samples` to every pixel of a tile, unless the deadline has already passed
+      std::atomic<long> samples_taken{0};
+      auto sample_tile = [this, &world, &lights, &estimates, &samples_taken](const int tile, const int samples) {
+        const int last_row = std::min((tile + 1) * tile_height, image_height);
+        for (int j = tile * tile_height; j < last_row; ++j) {
           for (int i = 0; i < image_width; ++i) {
-            write_color(out, render_kernel(world, j, i));
+            add_samples<Variant>(world, lights, j, i, samples, estimates[j * image_width + i]);
           }
         }
+        samples_taken += static_cast<long>(last_row - tile * tile_height) * image_width * samples;
+      };
+
+      // Spread the initial pass over the image (every `initial_stride`th tile first), so if the deadline
+      // cuts it short the missing tiles are scattered and have sampled neighbours. The first tile is
+      // always sampled so there is something to fill the image from.
+      std::vector<int> initial_order;
+      initial_order.reserve(tile_count);
+      for (int offset = 0; offset < initial_stride; ++offset) {
+        for (int tile = offset; tile < tile_count; tile += initial_stride)
+          initial_order.push_back(tile);
       }
 
-      // the spaces to cover the scanlines remaining message
-      std::clog << "\rDone.                 \n";
+      std::clog << "Initial pass..." << std::flush;
+      for_each_tile(tile_count, [&sample_tile, &initial_order, deadline](const int index) {
+        if (index == 0 || clock::now() < deadline)
+          sample_tile(initial_order[index], initial_samples);
+      });
+      std::clog << "\rInitial pass: " << samples_taken / std::chrono::duration<double>(clock::now() - start).count()
+                << " samples per second\n";
+
+      const long tile_cost = static_cast<long>(tile_height) * image_width * pass_samples;
+      std::vector<int> by_noise(tile_count);
+      std::vector<double> noise(tile_count);
+      int passes = 0;
+      while (true) {
+        const auto now = clock::now();
+        if (now >= deadline)
+          break;
+
+        // Estimate how many tiles fit in the remaining time from the throughput so far.
+        // Each pass is capped at half of the tiles so the noisiest ones are revisited more often.
+        const double throughput = samples_taken / std::chrono::duration<double>(now - start).count();
+        const double seconds_left = std::chrono::duration<double>(deadline - now).count();
+        const long affordable_tiles = static_cast<long>(throughput * seconds_left) / tile_cost;
+        const int pass_tiles = static_cast<int>(std::min<long>(affordable_tiles, std::max(1, tile_count / 2)));
+        if (pass_tiles == 0)
+          break;
+
+        for (int tile = 0; tile < tile_count; ++tile) {
+          by_noise[tile] = tile;
+          noise[tile] = tile_noise(estimates, tile);
+        }
+        std::partial_sort(by_noise.begin(), by_noise.begin() + pass_tiles, by_noise.end(),
+                          [&noise](const int a, const int b) { return noise[a] > noise[b]; });
+
+        std::clog << "\rAdaptive pass " << passes + 1 << ": " << pass_tiles << " tiles, "
+                  << std::chrono::duration_cast<std::chrono::milliseconds>(deadline - now).count() << " ms left    "
+                  << std::flush;
+
+        // Throughput estimates can be off, so skip the rest of the pass once the deadline hits
+        for_each_tile(pass_tiles, [&sample_tile, &by_noise, deadline](const int index) {
+          if (clock::now() < deadline)
+            sample_tile(by_noise[index], pass_samples);
+        });
+        ++passes;
+      }
+
+      std::vector<color> frame(image_width * image_height);
+      std::vector<int> achieved(image_width * image_height);
+      for (size_t p = 0; p < estimates.size(); ++p) {
+        achieved[p] = estimates[p].samples;
+        if (achieved[p] > 0)
+          frame[p] = resolve(estimates[p].sum, estimates[p].samples);
+      }
+      const int unsampled_tiles = fill_unsampled_rows(frame, achieved);
+
+      // Every tile is already done, so the output stage runs right here instead of on its own thread.
+      // Its scanline progress would only show up after the work is done, so it is left out.
+      tile_queue finished(tile_count);
+      for (int tile = 0; tile < tile_count; ++tile)
+        finished.push(tile);
+      clock::time_point first_tile_written;
+      write_tiles<typename Variant::output>(out, frame, finished, first_tile_written, false);
+
+      const auto [fewest, most] = std::minmax_element(achieved.begin(), achieved.end());
+      using ms = std::chrono::duration<double, std::milli>;
+      const double total_ms = ms(clock::now() - start).count();
+      std::clog << "\rDone.                                        \n"
+                << "Adaptive passes: " << passes << '\n'
+                << "Samples per pixel: min " << *fewest
+                << ", average " << static_cast<double>(samples_taken) / achieved.size()
+                << ", max " << *most << '\n'
+                << "Total time: " << total_ms << " ms"
+                << " (budget " << budget.count() << " ms)\n";
+      if (unsampled_tiles > 0 || total_ms > budget.count()) {
+        std::clog << "Budget could not be met:";
+        if (unsampled_tiles > 0)
+          std::clog << ' ' << unsampled_tiles << " of " << tile_count << " tiles were not sampled and were filled in from their neighbours";
+        if (unsampled_tiles > 0 && total_ms > budget.count())
+          std::clog << ';';
+        if (total_ms > budget.count())
+          std::clog << " over by " << total_ms - budget.count() << " ms";
+        std::clog << '\n';
+      }
+
+      return achieved;
     }
 
 private:
-    
-  color render_kernel(const hittable& world, const int j, const int i) const noexcept {
+
+  // Running totals for a pixel in the deadline-aware mode
+  struct pixel_estimate {
+    color sum;
+    double luminance_sum = 0;
+    double luminance_squared_sum = 0;
+    int samples = 0;
+  };
+
+  // Calls `f.template operator()<Variant>()` with the variant to render with.
+  // Median benchmarks (cameraVariants, see output/times.txt) didn't show the fixed lens and depth
+  // variants to be reliably faster than the runtime checks, so by default every camera uses the
+  // runtime checks. With RTW_SPECIALIZED_VARIANTS the precompiled variant matching this camera is
+  // picked instead; cameras with a bounce limit that wasn't precompiled use the runtime depth check.
+  template <typename Sampler, typename Output, typename F>
+  void dispatch(const F& f) const noexcept {
+#ifdef RTW_SPECIALIZED_VARIANTS
+    if (defocus_angle <= 0)
+      dispatch_depth<pinhole_lens, Sampler, Output>(f);
+    else
+      dispatch_depth<thin_lens, Sampler, Output>(f);
+#else
+    f.template operator()<camera_variant<runtime_lens, runtime_depth, Sampler, Output>>();
+#endif
+  }
+
+  template <typename Lens, typename Sampler, typename Output, typename F>
+  void dispatch_depth(const F& f) const noexcept {
+    switch (max_depth) {
+      case 10:
+        f.template operator()<camera_variant<Lens, fixed_depth<10>, Sampler, Output>>();
+        break;
+      case 50:
+        f.template operator()<camera_variant<Lens, fixed_depth<50>, Sampler, Output>>();
+        break;
+      default:
+        f.template operator()<camera_variant<Lens, runtime_depth, Sampler, Output>>();
+        break;
+    }
+  }
+
+  // Runs `render_tile` for every index in [0, count) on as many threads as the CPU can handle.
+  // Each thread grabs the next unrendered tile until there are none left, so a slow tile doesn't hold
+  // up the other threads. If the cpu count wasn't found for some reason, a single thread is used.
+  template <typename F>
+  static void for_each_tile(const int count, const F& render_tile) noexcept {
+    const int thread_count = std::max(1u, std::thread::hardware_concurrency());
+    std::atomic<int> next_tile{0};
+
+    std::vector<std::thread> threads;
+    threads.reserve(thread_count);
+    for (int t = 0; t < thread_count; ++t) {
+      threads.emplace_back([&render_tile, &next_tile, count] {
+        for (int tile = next_tile++; tile < count; tile = next_tile++)
+          render_tile(tile);
+      });
+    }
+
+    for (auto& thread : threads)
+      thread.join();
+  }
+
+  // Output stage, run on its own thread. Tiles finish in any order, but a PPM has to be written
+  // top to bottom, so finished tiles wait here until every tile above them has been written.
+  template <typename Output>
+  void write_tiles(std::ostream &out, const std::vector<color>& frame, tile_queue& finished,
+                   std::chrono::steady_clock::time_point& first_tile_written, const bool show_progress) const noexcept {
+    Output::write_header(out, image_width, image_height);
+
+    std::vector<bool> done(finished.size());
+    int next = 0;
+    for (int popped = 0; popped < finished.size(); ++popped) {
+      done[finished.pop()] = true;
+
+      while (next < finished.size() && done[next]) {
+        // Encode the whole tile before touching the stream, and flush it so a viewer sees it right away
+        std::ostringstream encoded;
+        const int last_row = std::min((next + 1) * tile_height, image_height);
+        for (int p = next * tile_height * image_width; p < last_row * image_width; ++p)
+          Output::write_pixel(encoded, frame[p]);
+        out << encoded.str() << std::flush;
+
+        if (next == 0)
+          first_tile_written = std::chrono::steady_clock::now();
+        ++next;
+        if (show_progress)
+          std::clog << "\rScanlines remaining: " << (image_height - last_row) << ' ' << std::flush;
+      }
+    }
+  }
+
+  // Copies the closest sampled scanline into every scanline without samples, for tiles the deadline-aware
+  // mode couldn't reach. Returns how many tiles were filled in.
+  int fill_unsampled_rows(std::vector<color>& frame, const std::vector<int>& samples) const noexcept {
+    auto sampled = [this, &samples](const int j) { return samples[j * image_width] > 0; };
+
+    int unsampled_rows = 0;
+    for (int j = 0; j < image_height; ++j) {
+      if (sampled(j))
+        continue;
+      ++unsampled_rows;
+
+      for (int distance = 1; distance < image_height; ++distance) {
+        const int source = (j - distance >= 0 && sampled(j - distance)) ? j - distance
+                         : (j + distance < image_height && sampled(j + distance)) ? j + distance
+                         : -1;
+        if (source >= 0) {
+          std::copy_n(frame.begin() + source * image_width, image_width, frame.begin() + j * image_width);
+          break;
+        }
+      }
+    }
+
+    // Tiles are sampled whole, so only the last one can be partly made of rows
+    return (unsampled_rows + tile_height - 1) / tile_height;
+  }
+
+  template <typename Variant>
+  color render_kernel(const hittable& world, const hittable& lights, const int j, const int i) const noexcept {
     color pixel_color(0,0,0);
     for (int sample = 0; sample < samples_per_pixel; ++sample) {
-      const ray r = get_ray(i, j);
-      pixel_color += ray_color(r, max_depth, world);
+      const ray r = get_ray<Variant>(i, j, sample, samples_per_pixel);
+      pixel_color += ray_color<typename Variant::depth>(r, max_depth, world, lights, true);
+    }
+
+    return resolve(pixel_color, samples_per_pixel);
+  }
+
+  // The total number of samples a pixel will get isn't known in the deadline-aware mode, so samplers
+  // only see each call's own `samples`. stratified_sampler therefore spreads the samples of one call,
+  // and with 2 samples per pass it is the same as jittered_sampler.
+  template <typename Variant>
+  void add_samples(const hittable& world, const hittable& lights, const int j, const int i, const int samples,
+                   pixel_estimate& estimate) const noexcept {
+    for (int sample = 0; sample < samples; ++sample) {
+      const ray r = get_ray<Variant>(i, j, sample, samples);
+      const color sample_color = ray_color<typename Variant::depth>(r, max_depth, world, lights, true);
+      const double luminance = luminance_of(sample_color);
+      estimate.sum += sample_color;
+      estimate.luminance_sum += luminance;
+      estimate.luminance_squared_sum += luminance * luminance;
+    }
+    estimate.samples += samples;
+  }
+
+  // Average relative standard error of the pixels in a tile; higher means noisier
+  double tile_noise(const std::vector<pixel_estimate>& estimates, const int tile) const noexcept {
+    const int first = tile * tile_height * image_width;
+    const int last = std::min((tile + 1) * tile_height, image_height) * image_width;
+    double total = 0;
+    for (int p = first; p < last; ++p) {
+      const pixel_estimate& e = estimates[p];
+      // Tiles the initial pass didn't reach come first
+      if (e.samples == 0)
+        return infinity;
+      const double mean = e.luminance_sum / e.samples;
+      const double variance = std::max(e.luminance_squared_sum / e.samples - mean * mean, 0.0);
+      // The offset keeps near black pixels from dominating
+      total += sqrt(variance / e.samples) / (mean + 0.05);
     }
+    return total / (last - first);
+  }
 
-    pixel_color /= samples_per_pixel;
+  // Averages the samples of a pixel and converts it to the displayable range
+  static color resolve(color pixel_color, const int samples) noexcept {
+    pixel_color /= samples;
 
     linear_to_gamma(pixel_color);
 
@@ -136,21 +434,44 @@ private:
     return pixel_color;
   }
 
-  color ray_color(const ray& r, const int depth, const hittable& world) const noexcept {
+  // `count_emitted` is false when the previous bounce already sampled the lights directly,
+  // so finding a light again here would count its contribution twice.
+  // With a fixed depth policy `depth` is unused; the bounces left are part of the type instead.
+  template <typename Depth>
+  color ray_color(const ray& r, const int depth, const hittable& world, const hittable& lights, const bool count_emitted) const noexcept {
     // If we have exceeded the ray bounce limit, no more light is gathered.
-    if (depth <= 0)
-      return color(0,0,0);
-    
+    if constexpr (Depth::fixed) {
+      if constexpr (Depth::value <= 0)
+        return color(0,0,0);
+      else
+        return shade<Depth>(r, depth, world, lights, count_emitted);
+    } else {
+      if (depth <= 0)
+        return color(0,0,0);
+      return shade<Depth>(r, depth, world, lights, count_emitted);
+    }
+  }
+
+  template <typename Depth>
+  color shade(const ray& r, const int depth, const hittable& world, const hittable& lights, const bool count_emitted) const noexcept {
     hit_record record;
     // look for hits that aren't super close to the surface (which are likely due to floating point rounding errors)
     if (world.hit(r, interval(0.001, infinity), record)) {
+      const color emitted = count_emitted ? record.mat->emitted() : black;
       color attenuation;
       ray scattered;
-      if (record.mat->scatter(r, record, attenuation, scattered))
-        // Get the color of the ray that bounced from this hit point
-        return attenuation * ray_color(scattered, depth-1, world);
-      else
-        return color(0,0,0);
+      if (!record.mat->scatter(r, record, attenuation, scattered))
+        return emitted;
+
+      if (record.mat->is_diffuse()) {
+        color direct;
+        const bool sampled = sample_direct_light(record, world, lights, direct);
+        // Get the color of the ray that bounced from this hit point, plus the light arriving straight from the lights
+        return emitted + attenuation * (direct + ray_color<typename Depth::next>(scattered, depth-1, world, lights, !sampled));
+      }
+
+      // Get the color of the ray that bounced from this hit point
+      return emitted + attenuation * ray_color<typename Depth::next>(scattered, depth-1, world, lights, true);
     }
 
     const vec3 unit_direction = unit_vector(r.direction());
@@ -158,23 +479,60 @@ private:
     return (1.0 - a) * white + a * sky_blue;
   }
 
-  ray get_ray(const int i, const int j) const noexcept {
+  bool sample_direct_light(const hit_record& record, const hittable& world, const hittable& lights, color& direct) const noexcept {
+    // Next event estimation: send a shadow ray toward a point on a light, and if nothing is in the way
+    // add its light weighted by the Lambertian BRDF (the albedo is applied by the caller).
+    direct = black;
+    vec3 direction;
+    double solid_angle;
+    color emission;
+    if (!lights.sample_light(record.p, direction, solid_angle, emission))
+      return false;
+
+    // A light was picked but it can't be seen from here, so there's nothing to add
+    if (solid_angle <= 0)
+      return true;
+
+    const double distance = direction.length();
+    const vec3 unit_direction = direction / distance;
+    const double cosine = dot(record.normal, unit_direction);
+    // The light is behind the surface, so it can't contribute, but it was still sampled
+    if (cosine <= 0)
+      return true;
+
+    // Trace a unit direction so the offsets at both ends are in world units, like for the other rays
+    if (!world.occluded(ray(record.p, unit_direction), interval(0.001, distance - 0.001)))
+      direct = emission * (cosine * solid_angle / pi);
+
+    return true;
+  }
+
+  template <typename Variant>
+  ray get_ray(const int i, const int j, const int sample, const int samples) const noexcept {
     // Get a randomly sampled camera ray for the pixel at location i,j, originating from
     // the camera defocus disk.
 
     const vec3 pixel_center = pixel00_loc + (i * pixel_delta_u) + (j * pixel_delta_v);
-    const vec3 pixel_sample = pixel_center + pixel_sample_square();
+    const vec3 pixel_sample = pixel_center + pixel_sample_square<typename Variant::sampler>(sample, samples);
 
-    const point3 ray_origin = (defocus_angle <= 0) ? center : defocus_disk_sample();
+    using lens = typename Variant::lens;
+    point3 ray_origin;
+    if constexpr (!lens::fixed)
+      ray_origin = (defocus_angle <= 0) ? center : defocus_disk_sample();
+    else if constexpr (lens::defocus)
+      ray_origin = defocus_disk_sample();
+    else
+      ray_origin = center;
     const vec3 ray_direction = pixel_sample - ray_origin;
 
     return ray(ray_origin, ray_direction);
   }
 
-  vec3 pixel_sample_square() const noexcept {
-    // Returns a random point in the square surrounding a pixel at the origin.
-    const double px = -0.5 + random_double();
-    const double py = -0.5 + random_double();
+  template <typename Sampler>
+  vec3 pixel_sample_square(const int sample, const int samples) const noexcept {
+    // Returns a point in the square surrounding a pixel at the origin.
+    double px, py;
+    Sampler::offset(sample, samples, px, py);
     return (px * pixel_delta_u) + (py * pixel_delta_v);
   }
 
@@ -192,6 +550,11 @@ private:
   const point3 center;   // Camera center
   const double vfov;     // Vertical view angle (field of view)
   const double defocus_angle; // TODO: consider making this optional
+  static constexpr int tile_height = 4; // Scanlines per tile handed to the output stage
+  static constexpr int initial_samples = 2; // Samples per pixel of the first deadline-aware pass; 2 allows a variance estimate
+  static constexpr int pass_samples = 2;    // Samples per pixel added to each tile in later passes
+  static constexpr int initial_stride = 8;  // Tile spacing of the first deadline-aware pass
+  static constexpr int output_reserve = 20; // The deadline-aware mode keeps 1/20 of the budget for writing the image
   point3 pixel00_loc;    // Location of pixel 0, 0
   vec3   pixel_delta_u;  // Offset to pixel to the right
   vec3   pixel_delta_v;  // Offset to pixel below
@@ -0,0 +1,113 @@
+#ifndef CAMERA_VARIANT_H
+#define CAMERA_VARIANT_H
+
+#include "rtweekend.h"
+
+#include "color.h"
+
+#include <iostream>
+
+// Compile-time policies for the camera's render loop. Each combination is its own instantiation, so
+// settings that are fixed for a variant don't need checking for every sample. `camera::render_variant`
+// renders with any of them; `camera::render` only picks the matching one when built with
+// RTW_SPECIALIZED_VARIANTS.
+
+// Lens policies: where camera rays start
+
+// Generic path: checks the camera's defocus angle for every ray
+struct runtime_lens {
+  static constexpr bool fixed = false;
+  static constexpr bool defocus = false;
+};
+
+// All rays start at the camera center (no depth of field)
+struct pinhole_lens {
+  static constexpr bool fixed = true;
+  static constexpr bool defocus = false;
+};
+
+// Rays start on the defocus disk
+struct thin_lens {
+  static constexpr bool fixed = true;
+  static constexpr bool defocus = true;
+};
+
+// Depth policies: how many times a ray can bounce
+
+// Generic path: the bounce limit is the camera's `max_depth`, counted down at runtime
+struct runtime_depth {
+  static constexpr bool fixed = false;
+  using next = runtime_depth;
+};
+
+// The bounce limit is part of the type, so each bounce is its own instantiation and the check is gone
+template <int N>
+struct fixed_depth {
+  static constexpr bool fixed = true;
+  static constexpr int value = N;
+  using next = fixed_depth<N-1>;
+};
+
+// Sampler policies: where in the pixel each sample goes, as an offset from the pixel center in [-0.5, 0.5)
+
+// A random point anywhere in the pixel for every sample
+struct jittered_sampler {
+  static void offset(const int sample, const int samples, double& px, double& py) noexcept {
+    px = -0.5 + random_double();
+    py = -0.5 + random_double();
+  }
+};
+
+// Splits the pixel into an n*n grid and puts one random point in each cell, which spreads the samples
+// more evenly. Samples that don't fit in the largest grid fall back to jittering over the whole pixel.
+// The deadline-aware render mode only passes the samples of one pass, so there it is mostly plain jitter.
+struct stratified_sampler {
+  static void offset(const int sample, const int samples, double& px, double& py) noexcept {
+    const int n = static_cast<int>(sqrt(samples));
+    if (sample >= n * n) {
+      jittered_sampler::offset(sample, samples, px, py);
+      return;
+    }
+    px = -0.5 + (sample % n + random_double()) / n;
+    py = -0.5 + (sample / n + random_double()) / n;
+  }
+};
+
+// Output policies: how the image is encoded
+
+// Plain text PPM, one pixel per line
+struct ppm_ascii {
+  static void write_header(std::ostream &out, const int width, const int height) {
+    out << "P3\n" << width << ' ' << height << "\n255\n";
+  }
+
+  static void write_pixel(std::ostream &out, const color& pixel_color) {
+    write_color(out, pixel_color);
+  }
+};
+
+// Binary PPM, three bytes per pixel; much smaller and faster to encode
+struct ppm_binary {
+  static void write_header(std::ostream &out, const int width, const int height) {
+    out << "P6\n" << width << ' ' << height << "\n255\n";
+  }
+
+  static void write_pixel(std::ostream &out, const color& pixel_color) {
+    out.put(static_cast<char>(static_cast<int>(255.99 * pixel_color.x())));
+    out.put(static_cast<char>(static_cast<int>(255.99 * pixel_color.y())));
+    out.put(static_cast<char>(static_cast<int>(255.99 * pixel_color.z())));
+  }
+};
+
+template <typename Lens, typename Depth, typename Sampler, typename Output>
+struct camera_variant {
+  using lens = Lens;
+  using depth = Depth;
+  using sampler = Sampler;
+  using output = Output;
+};
+
+// The fully runtime-checked render loop, equivalent to the camera before it was specialized
+using generic_variant = camera_variant<runtime_lens, runtime_depth, jittered_sampler, ppm_ascii>;
+
+#endif // CAMERA_VARIANT_H
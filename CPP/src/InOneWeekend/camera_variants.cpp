@@ -0,0 +1,100 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "rtweekend.h"
+
+#include "camera.h"
+#include "hittable_list.h"
+#include "scene.h"
+
+// Benchmarks each precompiled camera variant against the generic, runtime-checked render loop.
+// Usage: cameraVariants [repeats]   (the median of `repeats` renders is reported, 7 by default)
+// The variants take turns, one render each per round, so a machine slowing down or speeding up
+// during the run affects them all alike.
+
+constexpr int image_width = 200;
+constexpr int samples_per_pixel = 4;
+constexpr int max_depth = 50;
+
+struct benchmark {
+  std::string name;
+  std::function<void()> render;
+  std::vector<double> times;
+};
+
+template <typename Variant>
+benchmark make_benchmark(const std::string& name, const camera& cam, const hittable& world, const hittable& lights) {
+  return {name, [&cam, &world, &lights] {
+    std::ostringstream out;
+    cam.render_variant<Variant>(world, lights, out);
+  }, {}};
+}
+
+// Prints the median time of each benchmark and its speedup over the first one
+void run(std::vector<benchmark>& benchmarks, const int repeats) {
+  for (int r = 0; r < repeats; ++r) {
+    for (auto& b : benchmarks) {
+      const auto start = std::chrono::steady_clock::now();
+      b.render();
+      b.times.push_back(std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count());
+    }
+  }
+
+  double generic_ms = 0;
+  for (auto& b : benchmarks) {
+    std::nth_element(b.times.begin(), b.times.begin() + b.times.size() / 2, b.times.end());
+    const double ms = b.times[b.times.size() / 2];
+    if (generic_ms == 0)
+      generic_ms = ms;
+    std::cout << std::left << std::setw(40) << b.name << std::right << std::setw(10) << std::fixed << std::setprecision(1)
+              << ms << " ms" << std::setw(8) << std::setprecision(2) << generic_ms / ms << "x\n";
+  }
+}
+
+int main(int argc, char* argv[]) {
+  const int repeats = argc == 2 ? std::max(1, std::atoi(argv[1])) : 7;
+
+  hittable_list world;
+  hittable_list lights;
+  lit_random_spheres(world, lights);
+
+  const camera thin_lens_cam(16.0 / 9.0, image_width, samples_per_pixel, max_depth, 20,
+                             point3(13,2,3), point3(0,0,0), vec3(0,1,0), 0.6, 10);
+  const camera pinhole_cam(16.0 / 9.0, image_width, samples_per_pixel, max_depth, 20,
+                           point3(13,2,3), point3(0,0,0), vec3(0,1,0), 0, 10);
+
+  // Silence the render progress messages while timing
+  auto* const clog_buffer = std::clog.rdbuf(nullptr);
+
+  using depth = fixed_depth<max_depth>;
+
+  std::cout << "Thin lens camera (" << image_width << " wide, " << samples_per_pixel << " spp, depth " << max_depth
+            << ", median of " << repeats << ")\n";
+  std::vector<benchmark> thin_lens_benchmarks{
+    make_benchmark<generic_variant>("generic", thin_lens_cam, world, lights),
+    make_benchmark<camera_variant<thin_lens, runtime_depth, jittered_sampler, ppm_ascii>>("thin_lens", thin_lens_cam, world, lights),
+    make_benchmark<camera_variant<runtime_lens, depth, jittered_sampler, ppm_ascii>>("fixed_depth", thin_lens_cam, world, lights),
+    make_benchmark<camera_variant<thin_lens, depth, jittered_sampler, ppm_ascii>>("thin_lens + fixed_depth", thin_lens_cam, world, lights),
+    make_benchmark<camera_variant<thin_lens, runtime_depth, stratified_sampler, ppm_ascii>>("thin_lens + stratified_sampler", thin_lens_cam, world, lights),
+    make_benchmark<camera_variant<thin_lens, runtime_depth, jittered_sampler, ppm_binary>>("thin_lens + ppm_binary", thin_lens_cam, world, lights),
+  };
+  run(thin_lens_benchmarks, repeats);
+
+  std::cout << "Pinhole camera\n";
+  std::vector<benchmark> pinhole_benchmarks{
+    make_benchmark<generic_variant>("generic", pinhole_cam, world, lights),
+    make_benchmark<camera_variant<pinhole_lens, runtime_depth, jittered_sampler, ppm_ascii>>("pinhole_lens", pinhole_cam, world, lights),
+    make_benchmark<camera_variant<pinhole_lens, depth, jittered_sampler, ppm_ascii>>("pinhole_lens + fixed_depth", pinhole_cam, world, lights),
+  };
+  run(pinhole_benchmarks, repeats);
+
+  std::clog.rdbuf(clog_buffer);
+  return 0;
+}
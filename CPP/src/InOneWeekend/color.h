@@ -11,8 +11,14 @@ constexpr color red{1.0, 0.0, 0.0};
 constexpr color green{0.0, 1.0, 0.0};
 constexpr color blue{0.0, 0.0, 1.0};
 constexpr color white{1.0, 1.0, 1.0};
+constexpr color black{0.0, 0.0, 0.0};
 constexpr color sky_blue{0.5, 0.7, 1.0};
 
+// Perceived brightness of a linear color (Rec. 709 weights)
+constexpr double luminance_of(const color& c) noexcept {
+  return 0.2126 * c.x() + 0.7152 * c.y() + 0.0722 * c.z();
+}
+
 // Convert from linear to gamma space to correct darkness level
 inline double linear_to_gamma(const double linear_component) noexcept {
   return std::sqrt(linear_component);
@@ -24,11 +30,11 @@ inline void linear_to_gamma(color& c) noexcept {
   c.e[2] = linear_to_gamma(c.e[2]);
 }
 
-void write_color(std::ostream &out, color pixel_color) {
+inline void write_color(std::ostream &out, color pixel_color) {
   // Translate the components to [0,255] and write them out
   out << static_cast<int>(255.99 * pixel_color.x()) << ' '
       << static_cast<int>(255.99 * pixel_color.y()) << ' '
-      << static_cast<int>(255.99 * pixel_color.z()) << std::endl;
+      << static_cast<int>(255.99 * pixel_color.z()) << '\n';
 }
 
 #endif // COLOR_H
\ No newline at end of file
@@ -1,15 +1,27 @@
 #ifndef HITTABLE_H
 #define HITTABLE_H
 
+#include "color.h"
 #include "ray.h"
 
+#include <memory>
+
+class hittable;
 class material;
 
+// Result of the intersection phase; only what is needed to find the closest hit.
+class intersection {
+public:
+  double t;
+  const hittable* object; // The primitive that was hit
+};
+
+// Full surface data, only computed once for the closest hit.
 class hit_record {
 public:
   point3 p;
   vec3 normal;
-  std::shared_ptr<material> mat;
+  const material* mat;
   double t;
   bool front_face;
 
@@ -25,7 +37,35 @@ class hittable {
 public:
   virtual ~hittable() = default;
 
-  virtual bool hit(const ray& r, const interval ray_t, hit_record& rec) const noexcept = 0;
+  // Closest-hit query. Traversal only tracks the cheap `intersection`, and the hit point,
+  // normal and material are filled in by the primitive that was hit, once, at the end.
+  bool hit(const ray& r, const interval ray_t, hit_record& rec) const noexcept {
+    intersection isect;
+    if (!intersect(r, ray_t, isect))
+      return false;
+
+    isect.object->surface_interaction(r, isect, rec);
+    return true;
+  }
+
+  // Finds the closest intersection in ray_t and stores it in `isect`. On a miss `isect` must be left
+  // untouched: aggregates pass their closest hit so far to each child and rely on it surviving.
+  virtual bool intersect(const ray& r, const interval ray_t, intersection& isect) const noexcept = 0;
+
+  // Fills in `rec` for an intersection with this primitive.
+  virtual void surface_interaction(const ray& r, const intersection& isect, hit_record& rec) const noexcept = 0;
+
+  // Any-hit query for shadow rays. Returns as soon as any intersection in ray_t is found,
+  // without computing the hit point, normal, or material like `hit` does.
+  virtual bool occluded(const ray& r, const interval ray_t) const noexcept = 0;
+
+  // Light sampling for next event estimation. Picks a point on this object as seen from `origin`
+  // and sets `direction` to reach it at t = 1, along with the solid angle the object covers (the
+  // inverse of the sample's pdf) and the light it gives off. Returns false if nothing was sampled.
+  // A sample with a solid angle of 0 means a light was picked but contributes nothing from `origin`.
+  virtual bool sample_light(const point3& origin, vec3& direction, double& solid_angle, color& emission) const noexcept {
+    return false;
+  }
 };
 
-#endif // HITTABLE_H
\ No newline at end of file
+#endif // HITTABLE_H
@@ -1,8 +1,11 @@
 #ifndef HITTABLE_LIST_H
 #define HITTABLE_LIST_H
 
+#include "rtweekend.h"
+
 #include "hittable.h"
 
+#include <cassert>
 #include <memory>
 #include <vector>
 
@@ -22,21 +25,55 @@ public:
     objects.push_back(object);
   }
   
-  bool hit(const ray& r, const interval ray_t, hit_record& rec) const noexcept override {
-    hit_record temp_rec;
+  bool intersect(const ray& r, const interval ray_t, intersection& isect) const noexcept override {
     bool hit_anything = false;
     double closest_so_far = ray_t.max;
 
+    // Each closer hit narrows the interval, so `isect` ends up holding the closest one
     for (const auto& object : objects) {
-      if (object->hit(r, interval(ray_t.min, closest_so_far), temp_rec)) {
+      if (object->intersect(r, interval(ray_t.min, closest_so_far), isect)) {
         hit_anything = true;
-        closest_so_far = temp_rec.t;
-        rec = temp_rec;
+        closest_so_far = isect.t;
       }
     }
 
     return hit_anything;
   }
+
+  void surface_interaction(const ray& r, const intersection& isect, hit_record& rec) const noexcept override {
+    // Intersections always point at the primitive that was hit, never at a list
+    assert(false && "hittable_list never appears in an intersection");
+  }
+
+  bool occluded(const ray& r, const interval ray_t) const noexcept override {
+    // Unlike `hit` there is no need to find the closest object, so stop at the first one in the way
+    for (const auto& object : objects) {
+      if (object->occluded(r, ray_t))
+        return true;
+    }
+
+    return false;
+  }
+
+  bool sample_light(const point3& origin, vec3& direction, double& solid_angle, color& emission) const noexcept override {
+    if (objects.empty())
+      return false;
+
+    // Pick one light uniformly, which makes its pdf 1/size times smaller
+    const auto index = static_cast<size_t>(random_double() * objects.size());
+    if (!objects[index]->sample_light(origin, direction, solid_angle, emission)) {
+      // The chosen light can't be sampled from here (e.g. the origin is inside it). The other lights
+      // still skip their emission on the scattered ray, so this has to count as a sample with no light,
+      // otherwise their light would be counted twice.
+      direction = vec3(0,0,0);
+      solid_angle = 0;
+      emission = black;
+      return true;
+    }
+
+    solid_angle *= objects.size();
+    return true;
+  }
 };
 
 #endif // HITTABLE_LIST_H
\ No newline at end of file
@@ -18,7 +18,7 @@ public:
     return min < x && x < max;
   }
 
-  double clamp(const double x) const noexcept {
+  constexpr double clamp(const double x) const noexcept {
     if (x < min) return min;
     if (x > max) return max;
     return x;
@@ -12,6 +12,17 @@ public:
   virtual ~material() = default;
 
   virtual bool scatter(const ray& r_in, const hit_record& rec, color& attenuation, ray& scattered) const = 0;
+
+  // Light given off by the surface itself
+  virtual color emitted() const noexcept {
+    return black;
+  }
+
+  // Whether the surface scatters with a Lambertian distribution, so lights can be sampled directly
+  // with a shadow ray instead of waiting for a scattered ray to find them.
+  virtual bool is_diffuse() const noexcept {
+    return false;
+  }
 };
 
 // Diffused material using Lambertian distribution (darker shadows, more sky color)
@@ -31,6 +42,10 @@ public:
     return true;
   }
 
+  bool is_diffuse() const noexcept override {
+    return true;
+  }
+
 private:
   const color albedo;
 };
@@ -110,4 +125,21 @@ private:
   const color albedo;
 };
 
+// Light source; it only gives off light and doesn't scatter any rays
+class diffuse_light : public material {
+public:
+  constexpr diffuse_light(const color& c) : emit(c) {}
+
+  bool scatter(const ray& r_in, const hit_record& rec, color& attenuation, ray& scattered) const noexcept override {
+    return false;
+  }
+
+  color emitted() const noexcept override {
+    return emit;
+  }
+
+private:
+  const color emit;
+};
+
 #endif // MATERIAL_H
\ No newline at end of file
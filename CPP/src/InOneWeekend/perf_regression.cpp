@@ -0,0 +1,100 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "rtweekend.h"
+
+#include "camera.h"
+#include "hittable_list.h"
+#include "scene.h"
+
+// Renders a fixed reference scene and compares its throughput against a stored baseline.
+// Usage: perfRegression baseline.txt [threshold]   fails if throughput dropped by more than threshold (0.4 = 40%)
+//        perfRegression baseline.txt --update      measures and stores a new baseline
+// Baselines only compare on the same machine and build profile, so they aren't kept in the repository.
+
+constexpr int image_width = 300;
+constexpr int samples_per_pixel = 6;
+constexpr int max_depth = 50;
+constexpr int repeats = 7;
+
+int main(int argc, char* argv[]) {
+  if (argc < 2 || argc > 3) {
+    std::cerr << "Usage: " << argv[0] << " baseline.txt [threshold | --update]\n";
+    return -1;
+  }
+  const std::string baseline_path = argv[1];
+  const bool update = argc == 3 && std::string(argv[2]) == "--update";
+
+  double threshold = 0.4;
+  if (argc == 3 && !update) {
+    char* end;
+    threshold = std::strtod(argv[2], &end);
+    if (end == argv[2] || *end != '\0' || !(threshold >= 0 && threshold < 1)) {
+      std::cerr << "Invalid threshold `" << argv[2] << "`; expected a fraction in [0, 1), e.g. 0.4 for 40%\n";
+      return -1;
+    }
+  }
+
+  // Check for the baseline before spending time on the renders
+  double baseline = 0;
+  if (!update) {
+    std::ifstream baseline_in(baseline_path);
+    if (!(baseline_in >> baseline) || baseline <= 0) {
+      std::cerr << "No baseline in `" << baseline_path << "`. Create one from a known good build with the perf_baseline "
+                << "target (cmake --build <build dir> --target perf_baseline)\n";
+      return -1;
+    }
+  }
+
+  // The scene is the same on every run, since the random number generator always starts from the same seed
+  hittable_list world;
+  hittable_list lights;
+  lit_random_spheres(world, lights);
+
+  const camera cam(16.0 / 9.0, image_width, samples_per_pixel, max_depth, 20,
+                   point3(13,2,3), point3(0,0,0), vec3(0,1,0), 0.6, 10);
+  const int image_height = static_cast<int>(image_width / (16.0 / 9.0));
+
+  // Silence the render progress messages while timing, and use the median run to filter out noise
+  auto* const clog_buffer = std::clog.rdbuf(nullptr);
+  std::vector<double> seconds;
+  for (int r = 0; r < repeats; ++r) {
+    std::ostringstream out;
+    const auto start = std::chrono::steady_clock::now();
+    cam.render(world, lights, out);
+    seconds.push_back(std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count());
+  }
+  std::clog.rdbuf(clog_buffer);
+  std::sort(seconds.begin(), seconds.end());
+
+  const double samples = static_cast<double>(image_width) * image_height * samples_per_pixel;
+  const double throughput = samples / seconds[repeats / 2];
+  std::cout << "Throughput: " << throughput << " samples per second (median of " << repeats << " runs, "
+            << samples / seconds.back() << " to " << samples / seconds.front() << ")\n";
+
+  if (update) {
+    std::ofstream baseline_out(baseline_path);
+    if (!baseline_out || !(baseline_out << throughput << '\n')) {
+      std::cerr << "Could not write baseline `" << baseline_path << "`\n";
+      return -1;
+    }
+    std::cout << "Stored new baseline in `" << baseline_path << "`\n";
+    return 0;
+  }
+
+  const double change = throughput / baseline - 1;
+  std::cout << "Baseline:   " << baseline << " samples per second (" << (change >= 0 ? "+" : "") << change * 100 << "%)\n";
+  if (change < -threshold) {
+    std::cout << "FAILED: throughput dropped by more than " << threshold * 100 << "%\n";
+    return 1;
+  }
+
+  std::cout << "Passed\n";
+  return 0;
+}
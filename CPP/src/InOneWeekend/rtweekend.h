@@ -1,6 +1,8 @@
 #ifndef RTWEEKEND_H
 #define RTWEEKEND_H
 
+#include <atomic>
+#include <cstdint>
 #include <limits>
 #include <random>
 
@@ -17,8 +19,12 @@ constexpr inline double degrees_to_radian(const double degrees) {
 
 inline double random_double() noexcept {
   // Returns a random real in [0, 1)
-  static std::uniform_real_distribution<double> distribution(0.0, 1.0);
-  static std::mt19937 generator;
+  // Each thread gets its own generator so the render threads don't race on its state, and its own seed
+  // so they don't all repeat the same sequence. The first thread to ask (the main thread, building the
+  // scene) gets the default seed, so scenes are the same as with a single shared generator.
+  static std::atomic<std::uint_fast32_t> next_seed{std::mt19937::default_seed};
+  thread_local std::uniform_real_distribution<double> distribution(0.0, 1.0);
+  thread_local std::mt19937 generator(next_seed++);
   return distribution(generator);
 }
 
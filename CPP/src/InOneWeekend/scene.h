@@ -0,0 +1,66 @@
+#ifndef SCENE_H
+#define SCENE_H
+
+#include "rtweekend.h"
+
+#include "color.h"
+#include "hittable_list.h"
+#include "material.h"
+#include "sphere.h"
+
+// The final scene of the first book: a dense field of small random spheres around three large ones,
+// lit only by the sky.
+inline void random_spheres(hittable_list& world) {
+  auto ground_material = make_shared<lambertian>(color(0.5, 0.5, 0.5));
+  world.add(make_shared<sphere>(point3(0,-1000,0), 1000, ground_material));
+
+  for (int a = -11; a < 11; a++) {
+    for (int b = -11; b < 11; b++) {
+      auto choose_mat = random_double();
+      point3 center(a + 0.9*random_double(), 0.2, b + 0.9*random_double());
+
+      if ((center - point3(4, 0.2, 0)).length() > 0.9) {
+        shared_ptr<material> sphere_material;
+
+        if (choose_mat < 0.8) {
+          // diffuse
+          auto albedo = color::random() * color::random();
+          sphere_material = make_shared<lambertian>(albedo);
+          world.add(make_shared<sphere>(center, 0.2, sphere_material));
+        } else if (choose_mat < 0.95) {
+          // metal
+          auto albedo = color::random(0.5, 1);
+          auto fuzz = random_double(0, 0.5);
+          sphere_material = make_shared<metal>(albedo, fuzz);
+          world.add(make_shared<sphere>(center, 0.2, sphere_material));
+        } else {
+          // glass
+          sphere_material = make_shared<dielectric>(1.5);
+          world.add(make_shared<sphere>(center, 0.2, sphere_material));
+        }
+      }
+    }
+  }
+
+  auto material1 = make_shared<dielectric>(1.5);
+  world.add(make_shared<sphere>(point3(0, 1, 0), 1.0, material1));
+
+  auto material2 = make_shared<lambertian>(color(0.4, 0.2, 0.1));
+  world.add(make_shared<sphere>(point3(-4, 1, 0), 1.0, material2));
+
+  auto material3 = make_shared<metal>(color(0.7, 0.6, 0.5), 0.0);
+  world.add(make_shared<sphere>(point3(4, 1, 0), 1.0, material3));
+}
+
+// The same scene with a sphere light above it, out of view of the camera. The light is also added to
+// `lights` so diffuse surfaces sample it directly. Used by the benchmarks to exercise light sampling.
+inline void lit_random_spheres(hittable_list& world, hittable_list& lights) {
+  random_spheres(world);
+
+  auto light_material = make_shared<diffuse_light>(color(4, 4, 4));
+  auto light = make_shared<sphere>(point3(2, 8, 4), 1.5, light_material);
+  world.add(light);
+  lights.add(light);
+}
+
+#endif // SCENE_H
@@ -1,7 +1,10 @@
 #ifndef SPHERE_H
 #define SPHERE_H
 
+#include "rtweekend.h"
+
 #include "hittable.h"
+#include "material.h"
 #include "vec3.h"
 
 class sphere : public hittable {
@@ -12,7 +15,7 @@ public:
     mat{_mat}
   {}
 
-  bool hit(const ray& r, const interval ray_t, hit_record& rec) const noexcept override {
+  bool intersect(const ray& r, const interval ray_t, intersection& isect) const noexcept override {
     // See sections 5.1 and 6.2 for explanation of this math
     // In short, this checks if the ray hits the sphere by checking if there is
     // a point on the ray that satisfies the formula for the surface of a sphere.
@@ -35,12 +38,61 @@ public:
       }
     }
 
-    rec.t = root;
+    isect.t = root;
+    isect.object = this;
+
+    return true;
+  }
+
+  void surface_interaction(const ray& r, const intersection& isect, hit_record& rec) const noexcept override {
+    rec.t = isect.t;
     rec.p = r.at(rec.t);
-    vec3 outward_normal = (rec.p - center) / radius;
+    const vec3 outward_normal = (rec.p - center) / radius;
     rec.set_face_normal(r, outward_normal);
-    rec.mat = mat;
+    rec.mat = mat.get();
+  }
+
+  bool occluded(const ray& r, const interval ray_t) const noexcept override {
+    // Same test as `intersect`, but only the existence of a root in range matters
+    const vec3 oc = r.origin() - center;
+    const double a = r.direction().length_squared();
+    const double half_b = dot(oc, r.direction());
+    const double c = oc.length_squared() - radius*radius;
+
+    const double discriminant = half_b*half_b - a*c;
+    if (discriminant < 0) return false;
+
+    const double sqrtd = sqrt(discriminant);
+    return ray_t.surrounds((-half_b - sqrtd) / a) || ray_t.surrounds((-half_b + sqrtd) / a);
+  }
+
+  bool sample_light(const point3& origin, vec3& direction, double& solid_angle, color& emission) const noexcept override {
+    const vec3 to_center = center - origin;
+    const double distance_squared = to_center.length_squared();
+    // A point inside the sphere can't see it as a cone of directions
+    if (distance_squared <= radius*radius) return false;
+
+    // Sample a direction uniformly within the cone the sphere covers as seen from the origin
+    const double cos_theta_max = sqrt(1 - radius*radius / distance_squared);
+    const double cos_theta = 1 + random_double() * (cos_theta_max - 1);
+    const double sin_theta = sqrt(1 - cos_theta*cos_theta);
+    const double phi = 2 * pi * random_double();
+
+    // Build an orthonormal basis around the direction to the center
+    const vec3 w = to_center / sqrt(distance_squared);
+    const vec3 a = (fabs(w.x()) > 0.9) ? vec3(0, 1, 0) : vec3(1, 0, 0);
+    const vec3 v = unit_vector(cross(w, a));
+    const vec3 u = cross(w, v);
+    const vec3 unit_direction = cos(phi)*sin_theta*u + sin(phi)*sin_theta*v + cos_theta*w;
+
+    // Scale the direction to end at the near side of the sphere, so shadow rays can stop just before it.
+    // The discriminant can dip below zero from rounding at the edge of the cone.
+    const double half_b = dot(-to_center, unit_direction);
+    const double discriminant = fmax(half_b*half_b - (distance_squared - radius*radius), 0.0);
+    direction = (-half_b - sqrt(discriminant)) * unit_direction;
 
+    solid_angle = 2 * pi * (1 - cos_theta_max);
+    emission = mat->emitted();
     return true;
   }
 
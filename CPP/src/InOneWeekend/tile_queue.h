@@ -0,0 +1,46 @@
+#ifndef TILE_QUEUE_H
+#define TILE_QUEUE_H
+
+#include <atomic>
+#include <memory>
+
+// Lock-free multi-producer, single-consumer queue of finished tile indices.
+// The capacity is fixed up front; every tile is pushed exactly once per render, so it never wraps.
+class tile_queue {
+public:
+  explicit tile_queue(const int _capacity)
+  : capacity(_capacity),
+    slots(std::make_unique<slot[]>(_capacity))
+  {}
+
+  // Called by the render threads; this never blocks.
+  void push(const int tile) noexcept {
+    // Claim a slot, then publish the tile in it
+    slot& s = slots[tail.fetch_add(1, std::memory_order_relaxed)];
+    s.tile = tile;
+    s.ready.store(true, std::memory_order_release);
+    s.ready.notify_one();
+  }
+
+  // Called by the single consumer; waits until the next tile (in completion order) is pushed.
+  int pop() noexcept {
+    slot& s = slots[head++];
+    s.ready.wait(false, std::memory_order_acquire);
+    return s.tile;
+  }
+
+  int size() const noexcept { return capacity; }
+
+private:
+  struct slot {
+    int tile;
+    std::atomic<bool> ready{false};
+  };
+
+  const int capacity;
+  const std::unique_ptr<slot[]> slots;
+  std::atomic<int> tail{0};
+  int head = 0; // Only used by the consumer
+};
+
+#endif // TILE_QUEUE_H
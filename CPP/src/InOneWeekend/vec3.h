@@ -42,9 +42,9 @@ class vec3 {
     }
 
     constexpr void clamp(const interval t) noexcept {
-      t.clamp(e[0]);
-      t.clamp(e[1]);
-      t.clamp(e[2]);
+      e[0] = t.clamp(e[0]);
+      e[1] = t.clamp(e[1]);
+      e[2] = t.clamp(e[2]);
     }
 
     constexpr double length() const noexcept {